@@ -7,15 +7,21 @@ DATE : 09 / 12 / 2025
 DESCRIPTION:
 An interactive quiz game featuring :
 -5 Categories(Science, Computer, Sports, History, IQ)
-- 3 Difficulty Levels
+- Mixed mode drawing questions from all categories at once
+- 3 Difficulty Levels + Adaptive mode that follows the player's accuracy
 - Real - time countdown timer without blocking input
 - Lifelines(50 / 50, Skip, Replace, Extra Time)
 - Persistent High Score and Log tracking
+- Shared-memory leaderboard so several game windows see the same scores
+  (full score history kept in score_history.txt)
+- Near-duplicate question detection so a session never repeats a question
 - Input validation to prevent crashes
 
 NOTE :
 -Uses <conio.h> for _kbhit() (keyboard hit detection).
 - Uses <thread> and <chrono> for accurate timing and sleeping.
+- Uses SSE2/AVX2 intrinsics (picked at runtime, scalar fallback) to scan files.
+- Uses <windows.h> file mapping + a named mutex for the shared leaderboard.
 ================================================================================
 */
 
@@ -28,26 +34,90 @@ NOTE :
 #include <chrono>       // For high-resolution timer
 #include <thread>       // For this_thread::sleep_for()
 #include <conio.h>      // For _kbhit() and _getch() (Windows specific)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>    // For shared memory (file mapping), mutexes, Interlocked*()
+#include <vector>       // For delimiter position lists
+#include <cstring>      // For memcpy()
+#include <cctype>       // For isalnum() and tolower()
+#include <cmath>        // For pow()
+
+// SIMD headers are only available on x86/x64 MSVC builds
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>     // For __cpuid() and _BitScanForward()
+#include <immintrin.h>  // For SSE2 / AVX2 intrinsics and _xgetbv()
+#define QUIZ_SIMD_X86 1
+#endif
 
 using namespace std;
 
 // ======================= CONFIGURATION =======================
 const int TOTAL_QUESTIONS = 150;     // Max capacity for loading questions
 const int SESSION_QUESTIONS = 10;    // How many questions per game
+const int NUM_CATEGORIES = 5;        // Number of category banks
+const int MIXED_CATEGORY = 6;        // Menu choice for Mixed mode
+const int POOL_CAPACITY = 50 * NUM_CATEGORIES; // One difficulty slice from every bank
+
+// Bank file and display name for categories 1-5
+const string CATEGORY_FILES[NUM_CATEGORIES] = { "science.txt", "computer.txt", "sports.txt", "history.txt", "iq.txt" };
+const string CATEGORY_NAMES[NUM_CATEGORIES] = { "Science", "Computer", "Sports", "History", "IQ" };
+
+const int LEADERBOARD_SIZE = 100;    // Top scores kept in shared memory (and on disk)
+const int COMPACT_INTERVAL = 5;      // Rewrite high_scores.txt after this many new scores
+const char HISTORY_FILE[] = "score_history.txt"; // Every score ever saved (append-only)
+
+const int BANK_CAPACITY = TOTAL_QUESTIONS * NUM_CATEGORIES; // Question slots across all banks
+const int QUESTION_FIELDS = 7;       // Question|Opt1|Opt2|Opt3|Opt4|CorrectIdx|Tier
+const int LOAD_CHUNK = 64 * 1024;    // Bytes read per step when loading a bank
+const int SHINGLE_WORDS = 2;         // Words per shingle for near-duplicate detection
+const int MINHASH_SIZE = 32;         // Hashes in each question's MinHash signature
+const int MINHASH_BANDS = 8;         // LSH bands (MINHASH_SIZE / MINHASH_BANDS hashes each)
+const int MINHASH_MATCH = 28;        // Equal hashes needed to count as near-duplicates (~87% similar)
+
+const int ADAPTIVE_DIFFICULTY = 4;   // Menu choice for Adaptive mode
+const int RATING_BASE = 1000;        // Elo rating of a Medium question (and a new player)
+const int RATING_TIER_STEP = 200;    // Rating gap between Easy, Medium and Hard questions
+const double RATING_K = 64.0;        // How far one answer moves the player's rating
+
+// ======================= DATA STRUCTURES =======================
+
+// One high score row. Fixed-size char arrays so it can live in shared memory.
+struct ScoreEntry {
+    char player[32];
+    int score;
+    char category[16];
+    char difficulty[16];
+};
+
+/*
+ * Leaderboard shared by every game process on this machine.
+ * Writers hold the named mutex; readers never lock and use 'sequence'
+ * instead (seqlock): it is odd while a write is in progress, and a
+ * reader retries if it changed while copying.
+ */
+struct SharedLeaderboard {
+    volatile LONG sequence;              // Seqlock counter
+    LONG initialized;                    // 1 once loaded from high_scores.txt
+    LONG count;                          // Entries in use
+    LONG unsaved;                        // Scores added since last compaction to disk
+    ScoreEntry entries[LEADERBOARD_SIZE]; // Sorted by score, highest first
+};
 
 // ======================= GLOBAL VARIABLES =======================
 
 // --- File & Question Data ---
 string filename;                     // Current category filename
-string questions[TOTAL_QUESTIONS];   // Buffer to hold loaded lines from file
-int indices[50];                     // Indices available for current difficulty
-int used_indices[50];                // Track used questions to prevent repeats
+string questions[BANK_CAPACITY];     // Loaded lines (Mixed mode uses one 150-slot block per category)
+int field_end[BANK_CAPACITY][QUESTION_FIELDS]; // End offset of each field within its line (from the scanner)
+int indices[POOL_CAPACITY];          // Indices available for current difficulty (first 10 = this session)
+int pool_size = 0;                   // How many entries of 'indices' are valid
+int used_indices[POOL_CAPACITY];     // Track used questions to prevent repeats
 int used_count = 0;                  // How many questions used so far
 
 // --- Game State ---
 int score = 0;                       // Current player score
-int category = 0;                    // User selected category (1-5)
-int difficulty = 0;                  // User selected difficulty (1-3)
+int category = 0;                    // User selected category (1-5, 6 = Mixed)
+int difficulty = 0;                  // User selected difficulty (1-3, 4 = Adaptive)
 string playername;                   // Player name for logging
 int streak = 0;                      // Consecutive correct answers
 int timer = 15;                      // Seconds allowed per question
@@ -59,6 +129,23 @@ bool lifeline_skip = true;
 bool lifeline_replace = true;
 bool lifeline_extratime = true;
 
+// --- Shared Leaderboard ---
+HANDLE leaderboard_mapping = NULL;       // File mapping handle
+HANDLE leaderboard_mutex = NULL;         // Named mutex for writers
+SharedLeaderboard* leaderboard = NULL;   // NULL = not available, use the file directly
+
+// --- Duplicate Detection ---
+int question_cluster[BANK_CAPACITY]; // Cluster id per question slot (same id = near-duplicates)
+bool cluster_used[BANK_CAPACITY];    // Clusters already drawn this session
+
+// --- Adaptive Difficulty ---
+vector<pair<int, int> > rating_index; // (rating, question slot), sorted by rating
+double ability = RATING_BASE;        // Player's current Elo estimate
+int current_tier = 0;                // Tier (1-3) of the question on screen
+
+// --- Delimiter Scanner ---
+int scan_level = -1;                 // 0 = Scalar, 1 = SSE2, 2 = AVX2 (-1 = not detected yet)
+
 // --- Review System Data ---
 // Stores details of wrong answers to show at the end
 string incorrect_questions[SESSION_QUESTIONS];
@@ -69,13 +156,46 @@ int correct_count = 0;               // Total correct answers
 int wrong_count = 0;                 // Total wrong answers (same as above, distinct counter)
 
 // ======================= FUNCTION PROTOTYPES =======================
-string cut(string& s);
+string question_field(int slot, int field);
+int detect_scan_level();
+void scan_delimiters(const char* data, int length, vector<int>& positions, int max_lines = 0);
+bool read_whole_file(string filename, string& buffer);
+string slice_field(const string& buffer, int begin, int end);
 void shuffle_array(int arr[], int n);
-int load_questions(string filename);
+void store_question_line(int slot, const string& buffer, int begin, int end, int pipes);
+int load_questions(string filename, int offset = 0);
+void load_category_worker(int cat_index, int counts[]);
+void load_all_categories(int counts[]);
+int build_mixed_pool(int counts[]);
+int question_tier(const string& line);
+bool rating_less(const pair<int, int>& a, const pair<int, int>& b);
+void build_rating_index(int counts[], int banks);
+int count_rated_clusters();
+int pick_adaptive_question();
+void update_ability(bool correct);
+string normalize_text(const string& raw);
+string correct_answer_text(int slot);
+unsigned int mix_hash(unsigned int h);
+void minhash_signature(const string& text, unsigned int sig[]);
+int find_cluster(int parent[], int i);
+void build_duplicate_index(int first, int last);
+void dedupe_session();
 void display_question(string question, string options[], int correct_pos, int q_num, bool is_review);
 void start_quiz();
 void save_high_score(string player, int score, string category, string difficulty);
 void show_high_scores();
+void make_score_entry(ScoreEntry& e, string player, int score, string category, string difficulty);
+void append_score_history(string player, int score, string category, string difficulty);
+bool read_high_scores_file(string filename, vector<ScoreEntry>& rows);
+bool score_greater(const ScoreEntry& a, const ScoreEntry& b);
+bool attach_leaderboard();
+void detach_leaderboard();
+bool lock_leaderboard();
+void unlock_leaderboard();
+void insert_score_locked(const ScoreEntry& entry);
+bool read_leaderboard(ScoreEntry out[], int& count);
+void compact_leaderboard();
+BOOL WINAPI console_close_handler(DWORD event);
 bool get_answer_with_timer(int& answer, int time_limit);
 void display_timer_bar(int remaining);
 void use_lifeline_5050(string options[], int correct_pos);
@@ -94,6 +214,10 @@ int main() {
 
     srand(time(0)); // Seed random number generator with current time
 
+    // Join (or create) the shared leaderboard; falls back to the file if this fails
+    attach_leaderboard();
+    SetConsoleCtrlHandler(console_close_handler, TRUE);
+
     while (true) {
         // --- Main Menu Display ---
         system("cls");
@@ -129,9 +253,9 @@ int main() {
             // Category Selection with Validation Loop
             while (true) {
                 cout << "\n=== SELECT CATEGORY ===\n";
-                cout << "1. Science\n2. Computer\n3. Sports\n4. History\n5. IQ/Logic\n";
+                cout << "1. Science\n2. Computer\n3. Sports\n4. History\n5. IQ/Logic\n6. Mixed (All Categories)\n";
                 cout << "Enter choice: ";
-                if (cin >> category && category >= 1 && category <= 5) {
+                if (cin >> category && category >= 1 && category <= MIXED_CATEGORY) {
                     cin.ignore(10000, '\n');
                     break;
                 }
@@ -143,9 +267,9 @@ int main() {
             // Difficulty Selection with Validation Loop
             while (true) {
                 cout << "\n=== SELECT DIFFICULTY ===\n";
-                cout << "1. Easy\n2. Medium\n3. Hard\n";
+                cout << "1. Easy\n2. Medium\n3. Hard\n4. Adaptive (changes with your answers)\n";
                 cout << "Enter choice: ";
-                if (cin >> difficulty && difficulty >= 1 && difficulty <= 3) {
+                if (cin >> difficulty && difficulty >= 1 && difficulty <= ADAPTIVE_DIFFICULTY) {
                     cin.ignore();
                     break;
                 }
@@ -176,6 +300,10 @@ int main() {
         }
     }
 
+    // Flush any scores not yet written to disk
+    compact_leaderboard();
+    detach_leaderboard();
+
     cout << "\nThank you for playing!\n";
     return 0;
 }
@@ -183,21 +311,135 @@ int main() {
 // ======================= UTILITY FUNCTIONS =======================
 
 /*
- * Function: cut
- * Purpose: Splits a string based on the '|' delimiter.
- * Mechanism: Finds the first '|', returns the substring before it,
- *            and modifies the original string to remove that part.
+ * Function: question_field
+ * Purpose: Returns one '|' separated field of a loaded question line.
+ * Mechanism: Uses the field offsets recorded by load_questions(), so
+ *            the line is never searched or copied again.
+ */
+string question_field(int slot, int field) {
+    int begin = (field == 0) ? 0 : field_end[slot][field - 1] + 1;
+    int end = field_end[slot][field];
+    if (begin >= end) return ""; // Missing field
+    return questions[slot].substr(begin, end - begin);
+}
+
+// ======================= FAST TEXT SCANNING =======================
+
+/*
+ * Function: detect_scan_level
+ * Purpose: Checks once which instruction set the CPU supports for scanning.
+ * Returns: 2 for AVX2, 1 for SSE2, 0 for the plain scalar loop.
+ */
+int detect_scan_level() {
+    if (scan_level >= 0) return scan_level;
+    scan_level = 0;
+#ifdef QUIZ_SIMD_X86
+    int info[4];
+    __cpuid(info, 0);
+    int max_leaf = info[0];
+
+    __cpuid(info, 1);
+    if (info[3] & (1 << 26)) scan_level = 1; // EDX bit 26 = SSE2
+
+    // AVX2 needs CPU support AND the OS saving the YMM registers (OSXSAVE + XCR0)
+    bool os_saves_ymm = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) &&
+        ((_xgetbv(0) & 6) == 6);
+    if (os_saves_ymm && max_leaf >= 7) {
+        __cpuidex(info, 7, 0);
+        if (info[1] & (1 << 5)) scan_level = 2; // EBX bit 5 = AVX2
+    }
+#endif
+    return scan_level;
+}
+
+#ifdef QUIZ_SIMD_X86
+// Scans 16 bytes at a time. Returns where it stopped so the caller can finish the tail.
+// Stops early once 'lines' reaches max_lines (0 = no limit).
+int scan_delimiters_sse2(const char* data, int length, vector<int>& positions, int max_lines, int& lines) {
+    const __m128i newline = _mm_set1_epi8('\n');
+    const __m128i pipe = _mm_set1_epi8('|');
+    int i = 0;
+    for (; i + 16 <= length && (max_lines == 0 || lines < max_lines); i += 16) {
+        __m128i chunk = _mm_loadu_si128((const __m128i*)(data + i));
+        __m128i hits = _mm_or_si128(_mm_cmpeq_epi8(chunk, newline), _mm_cmpeq_epi8(chunk, pipe));
+        unsigned long mask = (unsigned long)_mm_movemask_epi8(hits);
+        while (mask) {
+            unsigned long bit;
+            _BitScanForward(&bit, mask);
+            positions.push_back(i + (int)bit);
+            if (data[i + bit] == '\n') lines++;
+            mask &= mask - 1; // Clear lowest set bit
+        }
+    }
+    return i;
+}
+
+// Same as above but 32 bytes at a time
+int scan_delimiters_avx2(const char* data, int length, vector<int>& positions, int max_lines, int& lines) {
+    const __m256i newline = _mm256_set1_epi8('\n');
+    const __m256i pipe = _mm256_set1_epi8('|');
+    int i = 0;
+    for (; i + 32 <= length && (max_lines == 0 || lines < max_lines); i += 32) {
+        __m256i chunk = _mm256_loadu_si256((const __m256i*)(data + i));
+        __m256i hits = _mm256_or_si256(_mm256_cmpeq_epi8(chunk, newline), _mm256_cmpeq_epi8(chunk, pipe));
+        unsigned long mask = (unsigned long)(unsigned int)_mm256_movemask_epi8(hits);
+        while (mask) {
+            unsigned long bit;
+            _BitScanForward(&bit, mask);
+            positions.push_back(i + (int)bit);
+            if (data[i + bit] == '\n') lines++;
+            mask &= mask - 1;
+        }
+    }
+    return i;
+}
+#endif
+
+/*
+ * Function: scan_delimiters
+ * Purpose: Finds every '\n' AND every '|' in a buffer in a single pass.
+ * Output: 'positions' receives the byte offsets in increasing order, so a
+ *         caller can walk them to get both line and field boundaries.
+ * Note: Uses AVX2/SSE2 when available, the scalar loop otherwise (and for the tail).
+ *       With max_lines > 0 it stops soon after that many '\n' have been found
+ *       (the last SIMD block may add a few extra offsets).
  */
-string cut(string& s) {
-    int pos = s.find('|');
-    if (pos == string::npos) {
-        string result = s;
-        s = ""; // String is empty now
-        return result;
+void scan_delimiters(const char* data, int length, vector<int>& positions, int max_lines) {
+    int i = 0;
+    int lines = 0;
+#ifdef QUIZ_SIMD_X86
+    int level = detect_scan_level();
+    if (level == 2) i = scan_delimiters_avx2(data, length, positions, max_lines, lines);
+    else if (level == 1) i = scan_delimiters_sse2(data, length, positions, max_lines, lines);
+#endif
+    for (; i < length && (max_lines == 0 || lines < max_lines); i++) {
+        if (data[i] == '\n' || data[i] == '|') {
+            positions.push_back(i);
+            if (data[i] == '\n') lines++;
+        }
     }
-    string part = s.substr(0, pos);
-    s = s.substr(pos + 1); // Update original string
-    return part;
+}
+
+// Reads an entire file into 'buffer' with one read, sized up front from the file length
+bool read_whole_file(string filename, string& buffer) {
+    ifstream fin(filename, ios::binary); // Binary: '\r' is stripped by slice_field()
+    if (!fin.is_open()) return false;
+    fin.seekg(0, ios::end);
+    streamoff size = fin.tellg();
+    fin.seekg(0, ios::beg);
+    if (size < 0) return false;
+
+    buffer.resize((size_t)size);
+    if (size > 0) fin.read(&buffer[0], size);
+    buffer.resize((size_t)fin.gcount());
+    fin.close();
+    return true;
+}
+
+// Returns buffer[begin, end) without a trailing '\r' (CRLF files)
+string slice_field(const string& buffer, int begin, int end) {
+    if (end > begin && buffer[end - 1] == '\r') end--;
+    return buffer.substr(begin, end - begin);
 }
 
 /*
@@ -214,22 +456,413 @@ void shuffle_array(int arr[], int n) {
     }
 }
 
+// Stores buffer[begin, end) as question 'slot'; fields after the last '|' end where the line ends
+void store_question_line(int slot, const string& buffer, int begin, int end, int pipes) {
+    questions[slot] = slice_field(buffer, begin, end);
+    for (int f = pipes; f < QUESTION_FIELDS; f++) field_end[slot][f] = (int)questions[slot].size();
+}
+
 /*
  * Function: load_questions
- * Purpose: Reads the specific text file into the 'questions' array.
+ * Purpose: Reads the specific text file into the 'questions' array,
+ *          starting at questions[offset].
+ * Mechanism: Reads LOAD_CHUNK bytes at a time and walks the offsets
+ *            reported by scan_delimiters(): '|' offsets become field_end[]
+ *            entries, '\n' offsets end the line. An unfinished line is
+ *            carried into the next chunk. Reading stops as soon as
+ *            TOTAL_QUESTIONS lines are stored, however big the file is.
  */
-int load_questions(string filename) {
-    ifstream fin(filename);
+int load_questions(string filename, int offset) {
+    ifstream fin(filename, ios::binary); // Binary: '\r' is stripped by slice_field()
     if (!fin.is_open()) return 0; // File error
 
+    string buffer;       // Unfinished line from the last chunk + the new chunk
+    vector<int> delims;
     int count = 0;
-    while (getline(fin, questions[count]) && count < TOTAL_QUESTIONS) {
-        count++;
+    int pipes = 0;       // '|' seen in the current line
+    while (count < TOTAL_QUESTIONS) {
+        int old_size = (int)buffer.size();
+        buffer.resize(old_size + LOAD_CHUNK);
+        fin.read(&buffer[old_size], LOAD_CHUNK);
+        int got = (int)fin.gcount();
+        buffer.resize(old_size + got);
+
+        if (got == 0) {
+            // End of file: last line may not end with a newline
+            if (!buffer.empty()) store_question_line(offset + count++, buffer, 0, (int)buffer.size(), pipes);
+            break;
+        }
+
+        // Only the new bytes need scanning; the carried-over part was scanned already
+        delims.clear();
+        scan_delimiters(buffer.data() + old_size, got, delims, TOTAL_QUESTIONS - count);
+
+        int line_start = 0;
+        for (size_t k = 0; k < delims.size() && count < TOTAL_QUESTIONS; k++) {
+            int pos = old_size + delims[k];
+            int slot = offset + count;
+            if (buffer[pos] == '|') {
+                if (pipes < QUESTION_FIELDS) field_end[slot][pipes] = pos - line_start;
+                pipes++;
+                continue;
+            }
+            store_question_line(slot, buffer, line_start, pos, pipes);
+            count++;
+            line_start = pos + 1;
+            pipes = 0;
+        }
+        buffer.erase(0, line_start); // Keep only the unfinished line
     }
     fin.close();
     return count; // Returns number of questions loaded
 }
 
+// Thread body: loads one category into its own 150-slot block (no shared writes)
+void load_category_worker(int cat_index, int counts[]) {
+    counts[cat_index] = load_questions(CATEGORY_FILES[cat_index], cat_index * TOTAL_QUESTIONS);
+}
+
+/*
+ * Function: load_all_categories
+ * Purpose: Loads all category files at the same time, one thread per file,
+ *          so loading takes as long as the slowest file, not all of them.
+ * Output: counts[c] = questions loaded for category c.
+ */
+void load_all_categories(int counts[]) {
+    detect_scan_level(); // Detect once here so the workers don't race on it
+
+    thread workers[NUM_CATEGORIES];
+    for (int c = 0; c < NUM_CATEGORIES; c++) {
+        workers[c] = thread(load_category_worker, c, counts);
+    }
+    for (int c = 0; c < NUM_CATEGORIES; c++) workers[c].join();
+
+    // Find near-duplicates across all banks, not just within one
+    build_duplicate_index(0, BANK_CAPACITY);
+}
+
+/*
+ * Function: build_mixed_pool
+ * Purpose: Prepares 'indices' for Mixed mode from the loaded banks.
+ * Logic:
+ * 1. Shuffles each category's slice for the chosen difficulty.
+ * 2. Takes one question from each category in turn (equal quota per
+ *    category) until the session is full, then appends the rest as
+ *    spares for the Replace lifeline.
+ * Returns: Pool size, or 0 if there are not enough questions.
+ */
+int build_mixed_pool(int counts[]) {
+    // Per-category list of available indices for this difficulty
+    int cat_indices[NUM_CATEGORIES][50];
+    int cat_size[NUM_CATEGORIES] = { 0 };
+    int startindex = (difficulty - 1) * 50;
+    for (int c = 0; c < NUM_CATEGORIES; c++) {
+        for (int i = startindex; i < startindex + 50 && i < counts[c]; i++) {
+            cat_indices[c][cat_size[c]++] = c * TOTAL_QUESTIONS + i;
+        }
+        shuffle_array(cat_indices[c], cat_size[c]);
+    }
+
+    // Round-robin over categories to fill the pool
+    int size = 0;
+    int taken[NUM_CATEGORIES] = { 0 };
+    bool added = true;
+    while (added) {
+        added = false;
+        for (int c = 0; c < NUM_CATEGORIES; c++) {
+            if (taken[c] < cat_size[c]) {
+                indices[size++] = cat_indices[c][taken[c]++];
+                added = true;
+            }
+        }
+    }
+    if (size < SESSION_QUESTIONS) return 0;
+
+    // Mix the session order so categories don't come in a fixed rotation
+    shuffle_array(indices, SESSION_QUESTIONS);
+    return size;
+}
+
+// ======================= ADAPTIVE DIFFICULTY =======================
+
+// Reads the tier (last field: 1 = Easy, 2 = Medium, 3 = Hard) of a question line
+int question_tier(const string& line) {
+    size_t pos = line.rfind('|');
+    int tier = (pos == string::npos) ? 0 : atoi(line.c_str() + pos + 1);
+    if (tier < 1 || tier > 3) tier = 2; // Unrated lines count as Medium
+    return tier;
+}
+
+bool rating_less(const pair<int, int>& a, const pair<int, int>& b) {
+    return a.first < b.first;
+}
+
+/*
+ * Function: build_rating_index
+ * Purpose: Builds 'rating_index', every loaded question sorted by rating,
+ *          for Adaptive mode. Bank c occupies slots [c * 150, c * 150 + counts[c]).
+ * Note: Questions are shuffled before the stable sort so equally rated
+ *       questions come out in a different order each session.
+ */
+void build_rating_index(int counts[], int banks) {
+    rating_index.clear();
+    for (int c = 0; c < banks; c++) {
+        for (int i = 0; i < counts[c]; i++) {
+            int slot = c * TOTAL_QUESTIONS + i;
+            if (questions[slot].empty()) continue;
+            int rating = RATING_BASE + (question_tier(questions[slot]) - 2) * RATING_TIER_STEP;
+            rating_index.push_back(make_pair(rating, slot));
+        }
+    }
+    for (int i = (int)rating_index.size() - 1; i > 0; i--) {
+        swap(rating_index[i], rating_index[rand() % (i + 1)]);
+    }
+    stable_sort(rating_index.begin(), rating_index.end(), rating_less);
+}
+
+/*
+ * Function: count_rated_clusters
+ * Purpose: Counts distinct near-duplicate clusters in 'rating_index'.
+ *          pick_adaptive_question() draws at most one question per
+ *          cluster, so this (not the number of entries) is how many
+ *          questions an Adaptive session can get.
+ */
+int count_rated_clusters() {
+    vector<bool> seen(BANK_CAPACITY, false);
+    int clusters = 0;
+    for (size_t k = 0; k < rating_index.size(); k++) {
+        int cluster = question_cluster[rating_index[k].second];
+        if (!seen[cluster]) {
+            seen[cluster] = true;
+            clusters++;
+        }
+    }
+    return clusters;
+}
+
+/*
+ * Function: pick_adaptive_question
+ * Purpose: Returns the unused question whose rating is closest to the
+ *          player's ability, and marks its cluster as used.
+ * Logic: Binary search (lower_bound) for the ability in 'rating_index',
+ *        then step outwards to the nearest entry not already drawn. Only
+ *        questions drawn this session are skipped, so the cost is
+ *        O(log n) however big the bank is.
+ * Returns: Question slot, or -1 if every question has been used.
+ */
+int pick_adaptive_question() {
+    int target = (int)(ability + 0.5);
+    int hi = (int)(lower_bound(rating_index.begin(), rating_index.end(), make_pair(target, -1)) - rating_index.begin());
+    int lo = hi - 1;
+    int n = (int)rating_index.size();
+
+    while (lo >= 0 || hi < n) {
+        // Take whichever side is closer to the target rating
+        bool take_hi = (lo < 0) ||
+            (hi < n && rating_index[hi].first - target <= target - rating_index[lo].first);
+        int slot = take_hi ? rating_index[hi++].second : rating_index[lo--].second;
+        if (cluster_used[question_cluster[slot]]) continue;
+        cluster_used[question_cluster[slot]] = true;
+        return slot;
+    }
+    return -1;
+}
+
+/*
+ * Function: update_ability
+ * Purpose: Elo update after an answer in Adaptive mode (O(1)).
+ *          expected = chance to answer a question of this rating correctly;
+ *          the rating moves by RATING_K * (result - expected).
+ */
+void update_ability(bool correct) {
+    if (difficulty != ADAPTIVE_DIFFICULTY) return;
+    double rating = RATING_BASE + (current_tier - 2) * RATING_TIER_STEP;
+    double expected = 1.0 / (1.0 + pow(10.0, (rating - ability) / 400.0));
+    ability += RATING_K * ((correct ? 1.0 : 0.0) - expected);
+}
+
+// ======================= DUPLICATE DETECTION =======================
+
+// Lowercased text with punctuation turned into single spaces
+string normalize_text(const string& raw) {
+    string text;
+    for (size_t i = 0; i < raw.size(); i++) {
+        unsigned char ch = (unsigned char)raw[i];
+        if (isalnum(ch) || ch >= 128) text += (char)tolower(ch);
+        else if (!text.empty() && text.back() != ' ') text += ' ';
+    }
+    if (!text.empty() && text.back() == ' ') text.pop_back();
+    return text;
+}
+
+// Normalized text of the correct option ("" if the CorrectIdx field is broken)
+string correct_answer_text(int slot) {
+    int correct = atoi(question_field(slot, 5).c_str());
+    if (correct < 1 || correct > 4) return "";
+    return normalize_text(question_field(slot, correct));
+}
+
+// Scrambles the bits of a 32-bit hash (MurmurHash3 finalizer)
+unsigned int mix_hash(unsigned int h) {
+    h ^= h >> 16;
+    h *= 0x85ebca6bu;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35u;
+    h ^= h >> 16;
+    return h;
+}
+
+/*
+ * Function: minhash_signature
+ * Purpose: Summarizes a question as MINHASH_SIZE numbers.
+ * Mechanism: Hashes every run of SHINGLE_WORDS consecutive words; for each
+ *            of the MINHASH_SIZE hash functions keeps the smallest value
+ *            seen. The share of equal numbers between two signatures
+ *            estimates how much wording the two questions share.
+ * Note: Word shingles (not characters) so "divisible by 2" and
+ *       "divisible by 3" count as different questions.
+ */
+void minhash_signature(const string& text, unsigned int sig[]) {
+    for (int h = 0; h < MINHASH_SIZE; h++) sig[h] = 0xffffffffu;
+
+    // Hash each word (text is already normalized to single spaces)
+    vector<unsigned int> words;
+    unsigned int word = 2166136261u;
+    for (size_t i = 0; i <= text.size(); i++) {
+        if (i == text.size() || text[i] == ' ') {
+            words.push_back(word);
+            word = 2166136261u;
+        }
+        else {
+            word = (word ^ (unsigned char)text[i]) * 16777619u; // FNV-1a
+        }
+    }
+
+    int windows = (int)words.size() - SHINGLE_WORDS + 1;
+    if (windows < 1) windows = 1; // Very short text = one shingle
+    for (int i = 0; i < windows; i++) {
+        unsigned int shingle = 0;
+        for (int j = i; j < i + SHINGLE_WORDS && j < (int)words.size(); j++) {
+            shingle = mix_hash(shingle ^ words[j]);
+        }
+        for (int h = 0; h < MINHASH_SIZE; h++) {
+            unsigned int value = mix_hash(shingle ^ (0x9e3779b9u * (h + 1)));
+            if (value < sig[h]) sig[h] = value;
+        }
+    }
+}
+
+// Union-find root lookup (with path halving)
+int find_cluster(int parent[], int i) {
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+/*
+ * Function: build_duplicate_index
+ * Purpose: Groups near-duplicate questions in slots [first, last) into clusters.
+ * Logic:
+ * 1. Computes a MinHash signature of every non-empty question's text.
+ * 2. For each band, sorts questions by the hash of their part of the
+ *    signature plus their correct answer. Questions with an equal key are
+ *    candidates (LSH), so we never compare every pair - cost is
+ *    O(n log n) instead of O(n^2).
+ * 3. Each candidate is checked against the first question of its group and
+ *    merged into that cluster if at least MINHASH_MATCH hashes agree AND
+ *    the correct answers are the same text. Same wording with a different
+ *    answer ("Which number is prime?" -> 13 / 97) is a different question.
+ * Output: question_cluster[] (the lowest slot in each cluster is its id).
+ */
+void build_duplicate_index(int first, int last) {
+    int n = last - first;
+    vector<unsigned int> sig(n * MINHASH_SIZE);
+    vector<int> parent(n);
+    vector<string> answer(n);
+    vector<unsigned int> answer_hash(n);
+    vector<int> valid; // Offsets of non-empty questions
+
+    for (int i = 0; i < n; i++) {
+        parent[i] = i;
+        string text = normalize_text(question_field(first + i, 0));
+        if (text.empty()) continue;
+        minhash_signature(text, &sig[i * MINHASH_SIZE]);
+
+        answer[i] = correct_answer_text(first + i);
+        answer_hash[i] = 2166136261u;
+        for (size_t j = 0; j < answer[i].size(); j++) {
+            answer_hash[i] = (answer_hash[i] ^ (unsigned char)answer[i][j]) * 16777619u; // FNV-1a
+        }
+        valid.push_back(i);
+    }
+
+    const int rows = MINHASH_SIZE / MINHASH_BANDS;
+    vector<pair<unsigned int, int> > buckets(valid.size());
+    for (int b = 0; b < MINHASH_BANDS; b++) {
+        for (size_t k = 0; k < valid.size(); k++) {
+            unsigned int key = answer_hash[valid[k]]; // Only same-answer questions share a bucket
+            for (int r = 0; r < rows; r++) {
+                key = mix_hash(key ^ sig[valid[k] * MINHASH_SIZE + b * rows + r]);
+            }
+            buckets[k] = make_pair(key, valid[k]);
+        }
+        sort(buckets.begin(), buckets.end());
+
+        size_t start = 0;
+        for (size_t k = 1; k <= buckets.size(); k++) {
+            if (k < buckets.size() && buckets[k].first == buckets[start].first) continue;
+            // buckets[start..k) share this band; compare each to the group's first entry
+            int leader = buckets[start].second;
+            for (size_t m = start + 1; m < k; m++) {
+                int other = buckets[m].second;
+                int equal = 0;
+                for (int h = 0; h < MINHASH_SIZE; h++) {
+                    if (sig[leader * MINHASH_SIZE + h] == sig[other * MINHASH_SIZE + h]) equal++;
+                }
+                if (equal >= MINHASH_MATCH && answer[leader] == answer[other]) {
+                    int a = find_cluster(&parent[0], leader);
+                    int c = find_cluster(&parent[0], other);
+                    if (a < c) parent[c] = a; else parent[a] = c;
+                }
+            }
+            start = k;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        question_cluster[first + i] = first + find_cluster(&parent[0], i);
+    }
+}
+
+/*
+ * Function: dedupe_session
+ * Purpose: Makes sure the first SESSION_QUESTIONS entries of 'indices'
+ *          come from different clusters, swapping in spares from the rest
+ *          of the pool (same category first, to keep Mixed mode quotas).
+ *          Marks the chosen clusters in cluster_used[] for Replace.
+ */
+void dedupe_session() {
+    for (int i = 0; i < BANK_CAPACITY; i++) cluster_used[i] = false;
+
+    for (int q = 0; q < SESSION_QUESTIONS && q < pool_size; q++) {
+        if (cluster_used[question_cluster[indices[q]]]) {
+            int same_cat = -1, any_cat = -1;
+            for (int k = q + 1; k < pool_size && same_cat < 0; k++) {
+                if (cluster_used[question_cluster[indices[k]]]) continue;
+                if (k < SESSION_QUESTIONS) continue; // Already part of this session
+                if (any_cat < 0) any_cat = k;
+                if (indices[k] / TOTAL_QUESTIONS == indices[q] / TOTAL_QUESTIONS) same_cat = k;
+            }
+            int pick = (same_cat >= 0) ? same_cat : any_cat;
+            if (pick < 0) continue; // Pool has no other cluster left; keep the repeat
+            swap(indices[q], indices[pick]);
+        }
+        cluster_used[question_cluster[indices[q]]] = true;
+    }
+}
+
 /*
  * Function: get_current_datetime
  * Purpose: Returns current system time formatted as "YYYY-MM-DD HH:MM:SS"
@@ -359,24 +992,39 @@ bool use_lifeline_replace(int& current_index, int used_indices[], int& used_coun
     lifeline_replace = false;
     cout << "\n[LIFELINE] Replace Question Used. Finding new question...\n";
 
-    int start_index = (difficulty - 1) * 50;
+    // Adaptive mode: next closest question to the player's rating
+    if (difficulty == ADAPTIVE_DIFFICULTY) {
+        int slot = pick_adaptive_question();
+        if (slot < 0) return false;
+        current_index = slot;
+        used_indices[used_count++] = slot;
+        return true;
+    }
 
-    // Linear search for an unused question index
-    for (int i = start_index; i < start_index + 50; i++) {
-        bool is_used = false;
-        for (int j = 0; j < used_count; j++) {
+    // Linear search through the spare part of the pool for an unused question index.
+    // Prefers one from the same category so Mixed mode keeps its per-category quota.
+    int same_cat = -1, any_cat = -1;
+    for (int k = SESSION_QUESTIONS; k < pool_size && same_cat < 0; k++) {
+        int i = indices[k];
+        bool is_used = cluster_used[question_cluster[i]]; // Near-duplicate of one already drawn
+        for (int j = 0; j < used_count && !is_used; j++) {
             if (used_indices[j] == i) {
                 is_used = true;
                 break;
             }
         }
-        if (!is_used) {
-            current_index = i;              // Update current index
-            used_indices[used_count++] = i; // Mark new one as used
-            return true;
-        }
+        if (is_used) continue;
+        if (any_cat < 0) any_cat = k;
+        if (i / TOTAL_QUESTIONS == current_index / TOTAL_QUESTIONS) same_cat = k;
     }
-    return false;
+
+    int pick = (same_cat >= 0) ? same_cat : any_cat;
+    if (pick < 0) return false;
+    int i = indices[pick];
+    current_index = i;              // Update current index
+    used_indices[used_count++] = i; // Mark new one as used
+    cluster_used[question_cluster[i]] = true;
+    return true;
 }
 
 // Adds 10 seconds to the reference timer variable
@@ -410,52 +1058,117 @@ void save_quiz_log(string player, string category_str, string difficulty_str, in
     fout.close();
 }
 
-// Appends high score to high_scores.txt (Pipe delimited)
+/*
+ * Function: save_high_score
+ * Purpose: Records a score.
+ * Logic:
+ * 1. Appends it to score_history.txt at once (the full, append-only
+ *    record). This is done holding the named mutex, so lines from
+ *    different processes never interleave.
+ * 2. Inserts it into the shared leaderboard. high_scores.txt (top scores
+ *    only) is rewritten from it every COMPACT_INTERVAL scores and on exit.
+ * Note: Without shared memory only step 1 happens, still under the mutex.
+ */
 void save_high_score(string player, int score, string category, string difficulty) {
-    ofstream fout("high_scores.txt", ios::app);
+    if (leaderboard != NULL && lock_leaderboard()) {
+        append_score_history(player, score, category, difficulty);
+
+        ScoreEntry entry;
+        make_score_entry(entry, player, score, category, difficulty);
+        insert_score_locked(entry);
+        leaderboard->unsaved++;
+        bool compact_due = leaderboard->unsaved >= COMPACT_INTERVAL;
+        unlock_leaderboard();
+        if (compact_due) compact_leaderboard();
+        return;
+    }
+
+    bool locked = (leaderboard_mutex != NULL) && lock_leaderboard();
+    append_score_history(player, score, category, difficulty);
+    if (locked) unlock_leaderboard();
+}
+
+// Fills a fixed-size ScoreEntry (long names are cut to fit)
+void make_score_entry(ScoreEntry& e, string player, int score, string category, string difficulty) {
+    strncpy_s(e.player, sizeof(e.player), player.c_str(), _TRUNCATE);
+    e.score = score;
+    strncpy_s(e.category, sizeof(e.category), category.c_str(), _TRUNCATE);
+    strncpy_s(e.difficulty, sizeof(e.difficulty), difficulty.c_str(), _TRUNCATE);
+}
+
+/*
+ * Function: append_score_history
+ * Purpose: Appends one score line to score_history.txt.
+ * Note: Caller holds the mutex. The first time, the history starts as a
+ *       copy of high_scores.txt (which was the full history before the
+ *       shared leaderboard), so no old scores are lost.
+ */
+void append_score_history(string player, int score, string category, string difficulty) {
+    CopyFileA("high_scores.txt", HISTORY_FILE, TRUE); // Does nothing if the history exists
+
+    ofstream fout(HISTORY_FILE, ios::app);
     if (!fout.is_open()) return;
     fout << player << "|" << score << "|" << category << "|" << difficulty << "\n";
     fout.close();
 }
 
-// Reads, parses, sorts, and displays high scores
-void show_high_scores() {
-    const int maxentries = 100;
-    string player[maxentries];
-    int score[maxentries];
-    string category[maxentries];
-    string difficulty[maxentries];
-    int count = 0;
-
-    ifstream fin("high_scores.txt");
-    if (!fin.is_open()) {
-        cout << "No high scores found!\nPress Enter...";
-        cin.get();
-        return;
+/*
+ * Function: read_high_scores_file
+ * Purpose: Parses every row of a pipe delimited score file (file order, unsorted).
+ * Returns: false if the file could not be opened.
+ */
+bool read_high_scores_file(string filename, vector<ScoreEntry>& rows) {
+    string buffer;
+    if (!read_whole_file(filename, buffer)) return false;
+
+    // Parse the whole file in one pass: '|' ends a field, '\n' ends a row
+    vector<int> delims;
+    scan_delimiters(buffer.data(), (int)buffer.size(), delims);
+
+    string fields[4];
+    int field = 0;
+    int field_start = 0;
+    for (size_t k = 0; k <= delims.size(); k++) {
+        int pos = (k < delims.size()) ? delims[k] : (int)buffer.size();
+        if (field < 4) fields[field] = slice_field(buffer, field_start, pos);
+        field++;
+        field_start = pos + 1;
+
+        if (k == delims.size() || buffer[pos] == '\n') {
+            // Skip blank or broken rows instead of crashing on them
+            if (field >= 2 && !fields[0].empty() && !fields[1].empty()) {
+                ScoreEntry entry;
+                make_score_entry(entry, fields[0], atoi(fields[1].c_str()),
+                    (field > 2) ? fields[2] : "", (field > 3) ? fields[3] : "");
+                rows.push_back(entry);
+            }
+            field = 0;
+        }
     }
+    return true;
+}
 
-    // Parse file line by line
-    string line;
-    while (getline(fin, line) && count < maxentries) {
-        string temp = line;
-        player[count] = cut(temp);
-        score[count] = stoi(cut(temp));
-        category[count] = cut(temp);
-        difficulty[count] = cut(temp);
-        count++;
-    }
-    fin.close();
+bool score_greater(const ScoreEntry& a, const ScoreEntry& b) {
+    return a.score > b.score;
+}
 
-    // Bubble Sort (Descending Order by Score)
-    for (int i = 0; i < count - 1; i++) {
-        for (int j = 0; j < count - i - 1; j++) {
-            if (score[j] < score[j + 1]) {
-                swap(score[j], score[j + 1]);
-                swap(player[j], player[j + 1]);
-                swap(category[j], category[j + 1]);
-                swap(difficulty[j], difficulty[j + 1]);
-            }
+// Displays high scores from shared memory, or reads and sorts the history if that isn't available
+void show_high_scores() {
+    ScoreEntry snapshot[LEADERBOARD_SIZE];
+    int count = 0;
+
+    if (!read_leaderboard(snapshot, count)) {
+        vector<ScoreEntry> rows;
+        if (!read_high_scores_file(HISTORY_FILE, rows) && !read_high_scores_file("high_scores.txt", rows)) {
+            cout << "No high scores found!\nPress Enter...";
+            cin.get();
+            return;
         }
+
+        // Descending by score; equal scores keep file order
+        stable_sort(rows.begin(), rows.end(), score_greater);
+        count = ((int)rows.size() < LEADERBOARD_SIZE) ? (int)rows.size() : LEADERBOARD_SIZE;
+        for (int i = 0; i < count; i++) snapshot[i] = rows[i];
     }
 
     cout << "========================================\n";
@@ -463,13 +1176,176 @@ void show_high_scores() {
     cout << "========================================\n\n";
     cout << "Player\tScore\tCategory\tDifficulty\n";
     for (int i = 0; i < count; i++) {
-        cout << player[i] << "\t" << score[i] << "\t" << category[i] << "\t\t" << difficulty[i] << "\n";
+        cout << snapshot[i].player << "\t" << snapshot[i].score << "\t" << snapshot[i].category << "\t\t" << snapshot[i].difficulty << "\n";
     }
     cout << "\nPress Enter to return...";
     cin.ignore();
     cin.get();
 }
 
+// ======================= SHARED LEADERBOARD =======================
+
+/*
+ * Function: attach_leaderboard
+ * Purpose: Opens the named shared memory block (creating it if this is the
+ *          first game process) and fills it once from every row of
+ *          score_history.txt, so scores saved just before a crash are kept.
+ * Note: If the mapping fails the named mutex is still kept, so this
+ *       process's file writes stay serialized with the others.
+ */
+bool attach_leaderboard() {
+    leaderboard_mutex = CreateMutexA(NULL, FALSE, "Local\\QuizGameLeaderboardLock");
+    if (leaderboard_mutex == NULL) return false;
+
+    leaderboard_mapping = CreateFileMappingA(INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE,
+        0, sizeof(SharedLeaderboard), "Local\\QuizGameLeaderboard");
+    if (leaderboard_mapping != NULL) {
+        // New mappings are zero-filled, so 'initialized' starts at 0
+        leaderboard = (SharedLeaderboard*)MapViewOfFile(leaderboard_mapping, FILE_MAP_ALL_ACCESS, 0, 0, sizeof(SharedLeaderboard));
+    }
+    if (leaderboard == NULL) {
+        if (leaderboard_mapping != NULL) CloseHandle(leaderboard_mapping);
+        leaderboard_mapping = NULL;
+        return false;
+    }
+
+    if (!lock_leaderboard()) {
+        detach_leaderboard();
+        return false;
+    }
+    if (!leaderboard->initialized) {
+        CopyFileA("high_scores.txt", HISTORY_FILE, TRUE); // First run: start the history from the old file
+
+        // The table keeps only the top LEADERBOARD_SIZE, so every row can go through it
+        vector<ScoreEntry> rows;
+        read_high_scores_file(HISTORY_FILE, rows);
+        for (size_t i = 0; i < rows.size(); i++) insert_score_locked(rows[i]);
+
+        leaderboard->initialized = 1;
+    }
+    unlock_leaderboard();
+    return true;
+}
+
+// Unmaps the shared block and closes handles (the OS frees it after the last process)
+void detach_leaderboard() {
+    if (leaderboard != NULL) UnmapViewOfFile(leaderboard);
+    if (leaderboard_mapping != NULL) CloseHandle(leaderboard_mapping);
+    if (leaderboard_mutex != NULL) CloseHandle(leaderboard_mutex);
+    leaderboard = NULL;
+    leaderboard_mapping = NULL;
+    leaderboard_mutex = NULL;
+}
+
+// Takes the writer lock shared by all game processes
+bool lock_leaderboard() {
+    DWORD result = WaitForSingleObject(leaderboard_mutex, INFINITE);
+    if (result == WAIT_ABANDONED) {
+        // Previous owner died; if it was mid-write, close its seqlock section
+        if (leaderboard != NULL && (leaderboard->sequence & 1)) InterlockedIncrement(&leaderboard->sequence);
+        return true;
+    }
+    return result == WAIT_OBJECT_0;
+}
+
+void unlock_leaderboard() {
+    ReleaseMutex(leaderboard_mutex);
+}
+
+/*
+ * Function: insert_score_locked
+ * Purpose: Inserts a score into the sorted table (caller holds the lock).
+ * Note: Equal scores keep arrival order. Scores below the last place are dropped.
+ */
+void insert_score_locked(const ScoreEntry& entry) {
+    int count = leaderboard->count;
+    int pos = 0;
+    while (pos < count && leaderboard->entries[pos].score >= entry.score) pos++;
+    if (pos >= LEADERBOARD_SIZE) return;
+
+    InterlockedIncrement(&leaderboard->sequence); // Odd: readers will retry
+
+    int last = (count < LEADERBOARD_SIZE) ? count : LEADERBOARD_SIZE - 1;
+    for (int i = last; i > pos; i--) leaderboard->entries[i] = leaderboard->entries[i - 1];
+
+    leaderboard->entries[pos] = entry;
+    if (count < LEADERBOARD_SIZE) leaderboard->count = count + 1;
+
+    InterlockedIncrement(&leaderboard->sequence); // Even: write finished
+}
+
+/*
+ * Function: read_leaderboard
+ * Purpose: Copies the shared table without taking the lock.
+ * Logic: Read 'sequence', copy, read it again. If it was odd or changed,
+ *        a writer got in the way, so try again.
+ * Returns: false if shared memory is unavailable or a writer never finished.
+ */
+bool read_leaderboard(ScoreEntry out[], int& count) {
+    if (leaderboard == NULL) return false;
+
+    for (int attempt = 0; attempt < 1000; attempt++) {
+        LONG before = leaderboard->sequence;
+        if (before & 1) {
+            YieldProcessor();
+            continue;
+        }
+        MemoryBarrier();
+        count = leaderboard->count;
+        if (count > LEADERBOARD_SIZE) count = LEADERBOARD_SIZE;
+        memcpy(out, leaderboard->entries, count * sizeof(ScoreEntry));
+        MemoryBarrier();
+        if (leaderboard->sequence == before) {
+            for (int i = 0; i < count; i++) {
+                // Guard against a torn copy leaving a string unterminated
+                out[i].player[sizeof(out[i].player) - 1] = '\0';
+                out[i].category[sizeof(out[i].category) - 1] = '\0';
+                out[i].difficulty[sizeof(out[i].difficulty) - 1] = '\0';
+            }
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+ * Function: compact_leaderboard
+ * Purpose: Rewrites high_scores.txt (top scores only) from the shared table.
+ *          The full record stays in score_history.txt.
+ * Mechanism: Writes a temp file and renames it over the old one while
+ *            holding the lock, so two processes never write the file at
+ *            the same time and readers never see half a line.
+ */
+void compact_leaderboard() {
+    if (leaderboard == NULL || !lock_leaderboard()) return;
+    if (leaderboard->unsaved == 0) {
+        unlock_leaderboard();
+        return;
+    }
+
+    ofstream fout("high_scores.tmp");
+    if (fout.is_open()) {
+        for (int i = 0; i < leaderboard->count; i++) {
+            ScoreEntry& e = leaderboard->entries[i];
+            fout << e.player << "|" << e.score << "|" << e.category << "|" << e.difficulty << "\n";
+        }
+        fout.close();
+        if (MoveFileExA("high_scores.tmp", "high_scores.txt", MOVEFILE_REPLACE_EXISTING)) {
+            leaderboard->unsaved = 0;
+        }
+    }
+    unlock_leaderboard();
+}
+
+// Rewrites high_scores.txt when the console is closed, Ctrl+C is pressed, or Windows logs off / shuts down
+BOOL WINAPI console_close_handler(DWORD event) {
+    if (event == CTRL_CLOSE_EVENT || event == CTRL_C_EVENT || event == CTRL_BREAK_EVENT ||
+        event == CTRL_LOGOFF_EVENT || event == CTRL_SHUTDOWN_EVENT) {
+        compact_leaderboard();
+    }
+    return FALSE; // Let the default handler end the process
+}
+
 // ======================= GAME LOGIC =======================
 
 // Displays incorrect questions stored during the session
@@ -503,8 +1379,9 @@ void post_quiz_menu() {
         cout << "           QUIZ COMPLETE!\n";
         cout << "========================================\n";
         cout << "Score: " << score << "\n";
-        cout << "Correct: " << correct_count << " | Wrong: " << wrong_count << "\n\n";
-        cout << "1. Review Incorrect Questions\n";
+        cout << "Correct: " << correct_count << " | Wrong: " << wrong_count << "\n";
+        if (difficulty == ADAPTIVE_DIFFICULTY) cout << "Final Rating: " << (int)ability << "\n";
+        cout << "\n1. Review Incorrect Questions\n";
         cout << "2. Replay Quiz\n";
         cout << "3. Main Menu\n";
         cout << "Enter choice: ";
@@ -600,7 +1477,9 @@ void display_question(string question, string options[], int correct_pos, int q_
     bool answered_in_time = get_answer_with_timer(answer, current_timer);
 
     // Calculate penalty based on difficulty
-    int negativemark = (difficulty == 1) ? 2 : (difficulty == 2) ? 3 : 5;
+    // (Adaptive mode uses the tier of this question instead)
+    int tier = (difficulty == ADAPTIVE_DIFFICULTY) ? current_tier : difficulty;
+    int negativemark = (tier == 1) ? 2 : (tier == 2) ? 3 : 5;
 
     // --- TIMEOUT HANDLER ---
     if (!answered_in_time) {
@@ -608,6 +1487,7 @@ void display_question(string question, string options[], int correct_pos, int q_
         score -= negativemark;
         streak = 0;
         wrong_count++;
+        update_ability(false);
         // Save for review
         incorrect_questions[incorrect_count] = question;
         for (int i = 0; i < 4; i++) incorrect_options[incorrect_count][i] = shuffled_options[i];
@@ -630,6 +1510,7 @@ void display_question(string question, string options[], int correct_pos, int q_
             // Handle timeout after using lifeline
             score -= negativemark;
             wrong_count++;
+            update_ability(false);
             incorrect_questions[incorrect_count] = question;
             for (int i = 0; i < 4; i++) incorrect_options[incorrect_count][i] = shuffled_options[i];
             incorrect_correct_pos[incorrect_count] = new_correct;
@@ -661,6 +1542,7 @@ void display_question(string question, string options[], int correct_pos, int q_
         if (!answered_in_time) {
             score -= negativemark;
             wrong_count++;
+            update_ability(false);
             incorrect_questions[incorrect_count] = question;
             for (int i = 0; i < 4; i++) incorrect_options[incorrect_count][i] = shuffled_options[i];
             incorrect_correct_pos[incorrect_count] = new_correct;
@@ -679,6 +1561,7 @@ void display_question(string question, string options[], int correct_pos, int q_
         score++;
         streak++;
         correct_count++;
+        update_ability(true);
         // Bonus points logic
         if (streak == 3) { score += 5; cout << "Streak Bonus +5!\n"; }
         if (streak == 5) { score += 15; cout << "Streak Bonus +15!\n"; streak = 0; }
@@ -689,6 +1572,7 @@ void display_question(string question, string options[], int correct_pos, int q_
         cout << "Penalty: -" << negativemark << "\n";
         streak = 0;
         wrong_count++;
+        update_ability(false);
 
         // Save for review
         incorrect_questions[incorrect_count] = question;
@@ -706,37 +1590,98 @@ void display_question(string question, string options[], int correct_pos, int q_
  * Purpose: Main game loop. Loads questions and iterates through them.
  */
 void start_quiz() {
-    // Select File
-    switch (category) {
-    case 1: filename = "science.txt"; break;
-    case 2: filename = "computer.txt"; break;
-    case 3: filename = "sports.txt"; break;
-    case 4: filename = "history.txt"; break;
-    case 5: filename = "iq.txt"; break;
-    }
+    used_count = 0;
 
-    if (load_questions(filename) == 0) {
-        cout << "Failed to load questions. Check file existence.\nPress Enter...";
-        cin.get();
-        return;
+    ability = RATING_BASE;
+
+    if (category == MIXED_CATEGORY) {
+        // Loads every bank concurrently
+        int counts[NUM_CATEGORIES] = { 0 };
+        load_all_categories(counts);
+
+        // Every bank is needed for the per-category quota
+        for (int c = 0; c < NUM_CATEGORIES; c++) {
+            if (counts[c] == 0) {
+                cout << "Failed to load " << CATEGORY_NAMES[c] << " questions (" << CATEGORY_FILES[c]
+                    << "). Check file existence.\nPress Enter...";
+                cin.get();
+                return;
+            }
+        }
+
+        bool loaded_ok;
+        if (difficulty == ADAPTIVE_DIFFICULTY) {
+            // Whole pool, picked one question at a time below
+            build_rating_index(counts, NUM_CATEGORIES);
+            pool_size = 0;
+            loaded_ok = count_rated_clusters() >= SESSION_QUESTIONS;
+        }
+        else {
+            pool_size = build_mixed_pool(counts);
+            loaded_ok = pool_size > 0;
+        }
+        if (!loaded_ok) {
+            cout << "Failed to load questions. Check file existence.\nPress Enter...";
+            cin.get();
+            return;
+        }
     }
+    else {
+        // Select File
+        filename = CATEGORY_FILES[category - 1];
 
-    // Prepare Indices (Difficulty Logic)
-    used_count = 0;
-    int startindex = (difficulty - 1) * 50; // Easy=0, Medium=50, Hard=100
-    for (int i = 0; i < 50; i++) indices[i] = startindex + i;
-    shuffle_array(indices, 50);
+        int loaded = load_questions(filename);
+        if (loaded == 0) {
+            cout << "Failed to load questions. Check file existence.\nPress Enter...";
+            cin.get();
+            return;
+        }
+        build_duplicate_index(0, loaded);
+
+        if (difficulty == ADAPTIVE_DIFFICULTY) {
+            // Whole bank, picked one question at a time below
+            build_rating_index(&loaded, 1);
+            pool_size = 0;
+            if (count_rated_clusters() < SESSION_QUESTIONS) {
+                cout << "Failed to load questions. Check file existence.\nPress Enter...";
+                cin.get();
+                return;
+            }
+        }
+        else {
+            // Prepare Indices (Difficulty Logic)
+            int startindex = (difficulty - 1) * 50; // Easy=0, Medium=50, Hard=100
+            for (int i = 0; i < 50; i++) indices[i] = startindex + i;
+            shuffle_array(indices, 50);
+            pool_size = 50;
+        }
+    }
+    dedupe_session(); // No two questions from the same near-duplicate cluster
     score = 0;
 
     // Loop through 10 questions
+    int picked_slot = -1; // Adaptive: the slot 'q' already has a question chosen for it
+    bool ran_out = false; // Adaptive: no unused question left before the session was full
     for (int q = 0; q < SESSION_QUESTIONS; ) {
+        if (difficulty == ADAPTIVE_DIFFICULTY && picked_slot != q) {
+            int next = pick_adaptive_question();
+            if (next < 0) {
+                ran_out = true; // Bank exhausted
+                break;
+            }
+            indices[q] = next;
+            picked_slot = q;
+        }
+
         system("cls");
-        string line = questions[indices[q]];
+        int slot = indices[q];
+        current_tier = question_tier(questions[slot]);
 
-        // Parse the line (Question|Opt1|Opt2|Opt3|Opt4|CorrectIdx)
-        string question = cut(line);
-        string a = cut(line), b = cut(line), c = cut(line), d = cut(line);
-        string correct_str = cut(line);
+        // Fields of the line (Question|Opt1|Opt2|Opt3|Opt4|CorrectIdx), split at load time
+        string question = question_field(slot, 0);
+        string a = question_field(slot, 1), b = question_field(slot, 2);
+        string c = question_field(slot, 3), d = question_field(slot, 4);
+        string correct_str = question_field(slot, 5);
 
         // Validation against empty lines
         if (correct_str.empty() || question.empty()) {
@@ -744,7 +1689,12 @@ void start_quiz() {
         }
 
         string options[4] = { a, b, c, d };
-        cout << "Question " << q + 1 << " of " << SESSION_QUESTIONS << "\n\n";
+        cout << "Question " << q + 1 << " of " << SESSION_QUESTIONS;
+        if (difficulty == ADAPTIVE_DIFFICULTY) {
+            cout << "   [Level: " << (current_tier == 1 ? "Easy" : current_tier == 2 ? "Medium" : "Hard")
+                << " | Your rating: " << (int)ability << "]";
+        }
+        cout << "\n\n";
 
         // Show Question
         display_question(question, options, stoi(correct_str) - 1, q, false);
@@ -760,10 +1710,17 @@ void start_quiz() {
         q++;
     }
 
+    // A shortened session isn't comparable, so it isn't logged or saved
+    if (ran_out) {
+        cout << "Ran out of questions before the session was complete. Score not saved.\nPress Enter...";
+        cin.get();
+        return;
+    }
+
     // Prepare strings for logging
-    string cat_str = (category == 1 ? "Science" : category == 2 ? "Computer" :
-        category == 3 ? "Sports" : category == 4 ? "History" : "IQ");
-    string diff_str = (difficulty == 1 ? "Easy" : difficulty == 2 ? "Medium" : "Hard");
+    string cat_str = (category == MIXED_CATEGORY) ? "Mixed" : CATEGORY_NAMES[category - 1];
+    string diff_str = (difficulty == 1 ? "Easy" : difficulty == 2 ? "Medium" :
+        difficulty == 3 ? "Hard" : "Adaptive");
 
     // Save Data
     save_quiz_log(playername, cat_str, diff_str, correct_count, wrong_count, score);